@@ -0,0 +1,149 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file BenchHarness.h
+**
+** Timing, allocation and memory measurement of benchmark scenarios.
+*/
+
+
+#ifndef BENCHHARNESS_H
+#define BENCHHARNESS_H
+
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <ostream>
+
+#include "XmlSink.h"
+
+
+class BenchResult
+{
+  public:
+    BenchResult();
+
+    std::string scenario;
+    unsigned int numThreads;
+
+    // Set by the scenario. The rows are whatever the scenario counts, e.g.
+    // table rows, strings or categories, the bytes are its output.
+    unsigned long rows;
+    unsigned long bytes;
+
+    // Set by the harness, for the fastest run
+    double seconds;
+    unsigned long allocations;
+    unsigned long allocatedBytes;
+    unsigned long peakRssKb;
+
+    double GetRowsPerSecond() const;
+    double GetMegabytesPerSecond() const;
+
+    // One JSON object on one line
+    void WriteJson(std::ostream& io) const;
+
+    // Reads a line written by WriteJson(). Returns false, if the line is
+    // not a result.
+    bool ReadJson(const std::string& line);
+};
+
+
+class BenchScenario
+{
+  public:
+    BenchScenario(const std::string& name, const unsigned int numThreads = 1);
+    virtual ~BenchScenario();
+
+    const std::string& GetName() const;
+    unsigned int GetNumThreads() const;
+
+    // Not measured. Called once, before the runs.
+    virtual void SetUp();
+
+    // Measured. Fills in the rows and the bytes of the result.
+    virtual void Run(BenchResult& result) = 0;
+
+    // Not measured. Called once, after the runs.
+    virtual void TearDown();
+
+  private:
+    std::string _name;
+    unsigned int _numThreads;
+};
+
+
+/**
+** Each scenario is run the given number of times and the fastest run is
+** kept. Allocations are the operator new calls of all threads during the
+** run, allocations of C libraries, e.g. zlib, are not counted. The peak
+** resident set size is reset before each scenario where the kernel
+** allows it, otherwise it is the peak of the process so far.
+*/
+class BenchHarness
+{
+  public:
+    BenchHarness(const unsigned int numRepeats = 3);
+    ~BenchHarness();
+
+    // Scenarios whose names do not start with the filter are skipped.
+    void SetFilter(const std::string& filter);
+
+    bool IsSelected(const std::string& name) const;
+
+    // Runs the scenario if it is selected and writes its result
+    void Run(BenchScenario& scenario, std::ostream& io);
+
+    const std::vector<BenchResult>& GetResults() const;
+
+    static void ReadResults(std::vector<BenchResult>& results,
+      const std::string& fileName);
+
+    // Writes a comparison line per scenario of the baseline. Returns the
+    // number of scenarios whose rows per second dropped by more than the
+    // tolerance, a fraction.
+    static unsigned int Compare(std::ostream& io,
+      const std::vector<BenchResult>& results,
+      const std::vector<BenchResult>& baseline, const double tolerance);
+
+    static unsigned long GetNumAllocations();
+    static unsigned long GetNumAllocatedBytes();
+
+    static unsigned long GetPeakRssKb();
+    static bool ResetPeakRss();
+
+  private:
+    unsigned int _numRepeats;
+    std::string _filter;
+
+    std::vector<BenchResult> _results;
+
+    BenchHarness(const BenchHarness&);
+    BenchHarness& operator=(const BenchHarness&);
+};
+
+
+// Counts the bytes and drops them
+class CountingSink : public XmlSink
+{
+  public:
+    CountingSink();
+    ~CountingSink();
+
+    void Write(const char* data, const size_t len);
+    void Flush();
+
+    unsigned long GetNumBytes() const;
+    void Reset();
+
+  private:
+    unsigned long _numBytes;
+};
+
+
+#endif
@@ -0,0 +1,145 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file SyntheticData.h
+**
+** Synthetic tables, CIF files and dictionaries for the benchmarks.
+*/
+
+
+#ifndef SYNTHETICDATA_H
+#define SYNTHETICDATA_H
+
+
+#include <string>
+#include <vector>
+#include <ostream>
+
+#include "ISTable.h"
+#include "DicFile.h"
+#include "DataInfo.h"
+#include "ParentChild.h"
+
+
+typedef enum
+{
+    eSYNTH_KEY = 0,  // unique per row
+    eSYNTH_INT,
+    eSYNTH_FLOAT,
+    eSYNTH_STRING,   // short words, possibly with characters to escape
+    eSYNTH_TEXT      // several words, possibly with new lines
+} eSyntheticKind;
+
+
+class SyntheticColumn
+{
+  public:
+    std::string name;
+    eSyntheticKind kind;
+};
+
+
+/**
+** A synthetic category. All values are derived from the seed and the
+** row index, so tables, streamed rows and CIF files of the same spec hold
+** the same values.
+*/
+class SyntheticTableSpec
+{
+  public:
+    SyntheticTableSpec(const std::string& catName,
+      const unsigned int numRows);
+
+    std::string catName;
+    unsigned int numRows;
+    std::vector<SyntheticColumn> columns;
+
+    // Fractions of the non-key cells, from 0 to 1
+    double escapeDensity;      // strings and texts with markup or spaces
+    double scientificFraction; // floats in the exponent notation
+    double invalidFraction;    // numbers that are not valid numbers
+    double unknownFraction;    // "?" cells
+
+    unsigned int seed;
+
+    void AddColumn(const std::string& name, const eSyntheticKind kind);
+
+    // Columns named "<prefix>_<n>"
+    void AddColumns(const eSyntheticKind kind, const unsigned int num,
+      const std::string& prefix);
+
+    // An "id" key column followed by the given mix
+    static SyntheticTableSpec MakeMixed(const std::string& catName,
+      const unsigned int numRows, const unsigned int numInts,
+      const unsigned int numFloats, const unsigned int numStrings,
+      const unsigned int numTexts);
+
+    // The atom_site items of the compact atom record
+    static SyntheticTableSpec MakeAtomSite(const unsigned int numRows);
+};
+
+
+class SyntheticData
+{
+  public:
+    static void MakeRow(std::vector<std::string>& row,
+      const SyntheticTableSpec& spec, const unsigned int rowIndex);
+
+    static void GetColumnNames(std::vector<std::string>& columnNames,
+      const SyntheticTableSpec& spec);
+
+    // Owned by the caller
+    static ISTable* MakeTable(const SyntheticTableSpec& spec);
+
+    // One datablock with a loop per table
+    static void WriteCif(std::ostream& io, const std::string& blockName,
+      const std::vector<SyntheticTableSpec>& specs);
+};
+
+
+/**
+** A DDL2 dictionary that defines the categories of the table specs, plus
+** filler categories for the schema benchmarks. Each category after the
+** first is a child of the category before it, through a "parent_id" item
+** that is added to the filler categories. The dictionary is written to a
+** file and loaded through the dictionary library, so the benchmarks run
+** against real DataInfo and ParentChild objects.
+*/
+class SyntheticDictionary
+{
+  public:
+    SyntheticDictionary(const std::vector<SyntheticTableSpec>& specs,
+      const unsigned int numFillerCats,
+      const unsigned int numFillerItems);
+    ~SyntheticDictionary();
+
+    void Write(std::ostream& io) const;
+
+    // Writes the dictionary to the file and loads it
+    void Load(const std::string& dictFileName);
+
+    DataInfo& GetDataInfo();
+    ParentChild& GetParentChild();
+
+    unsigned int GetNumCategories() const;
+
+  private:
+    std::vector<SyntheticTableSpec> _specs;
+
+    DicFile* _dictFile;
+    DataInfo* _dataInfo;
+    ParentChild* _parentChild;
+
+    SyntheticDictionary(const SyntheticDictionary&);
+    SyntheticDictionary& operator=(const SyntheticDictionary&);
+
+    void _WriteCategory(std::ostream& io, const SyntheticTableSpec& spec,
+      const std::string& parentCatName) const;
+};
+
+
+#endif
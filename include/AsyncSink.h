@@ -0,0 +1,87 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file AsyncSink.h
+**
+** Output sink that writes to another sink on a background thread.
+*/
+
+
+#ifndef ASYNCSINK_H
+#define ASYNCSINK_H
+
+
+#include <cstddef>
+#include <string>
+#include <pthread.h>
+
+#include "Mutex.h"
+#include "XmlSink.h"
+
+
+/**
+** Double buffered: the writer fills one chunk while the background thread
+** passes the other one to the output sink, so that formatting overlaps
+** with e.g. compression in a GzipSink. Writers flush at every category,
+** so Flush() never waits: it hands the data to the background thread,
+** which then flushes the output sink, or, if the thread is still busy,
+** keeps the data for the next hand off. Only a full chunk waits for the
+** thread. Finish(), which the destructor calls, waits until all the data
+** has been written to the output sink and flushes it. The output sink
+** must not throw and must outlive this sink.
+*/
+class AsyncSink : public XmlSink
+{
+  public:
+    static const size_t DEFAULT_CHUNK_SIZE;
+
+    AsyncSink(XmlSink& out, const size_t chunkSize = DEFAULT_CHUNK_SIZE);
+    ~AsyncSink();
+
+    void Write(const char* data, const size_t len);
+    void Flush();
+
+    void Finish();
+
+    bool IsGood() const;
+
+  private:
+    XmlSink& _out;
+    size_t _chunkSize;
+
+    // Filled by the writer
+    std::string _front;
+
+    // Written out by the background thread while _backFull is set
+    std::string _back;
+    bool _backFull;
+    // Whether the output sink is flushed after the back buffer
+    bool _backFlush;
+
+    bool _good;
+    bool _stop;
+
+    mutable Mutex _mutex;
+    Condition _backReady;
+    Condition _backDone;
+
+    pthread_t _thread;
+
+    AsyncSink(const AsyncSink&);
+    AsyncSink& operator=(const AsyncSink&);
+
+    // Returns without handing off if the back buffer is full, unless
+    // asked to wait.
+    void _HandOff(const bool wait, const bool flush);
+    void _WaitBackDone();
+
+    static void* _Run(void* arg);
+    void _Work();
+};
+
+
+#endif
@@ -0,0 +1,137 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file BatchConverter.h
+**
+** Conversion of many CIF files to PDBML with one loaded dictionary.
+*/
+
+
+#ifndef BATCHCONVERTER_H
+#define BATCHCONVERTER_H
+
+
+#include <string>
+#include <vector>
+#include <ostream>
+
+#include "DataInfo.h"
+#include "Mutex.h"
+#include "ThreadPool.h"
+#include "TableWritePlan.h"
+#include "WriterMetrics.h"
+#include "DiagnosticSink.h"
+
+
+class BatchEntry
+{
+  public:
+    BatchEntry();
+    BatchEntry(const std::string& inFileName,
+      const std::string& outFileName);
+    ~BatchEntry();
+
+    std::string inFileName;
+    std::string outFileName;
+
+    // Set by the converter
+    bool ok;
+    std::string error;
+    std::string parsingDiags;
+    unsigned long inSize;
+    unsigned long outSize;
+    double parseSeconds;
+    double writeSeconds;
+
+    // Set if the converter collects metrics
+    WriterMetrics metrics;
+};
+
+
+/**
+** Entries are submitted largest input file first to a pool of workers,
+** which parse and write them as they become free, so at most one parsed
+** file per worker is held at any time. At most the in-flight limit of
+** entries are submitted and not yet done, which bounds the tasks queued
+** on the pool.
+**
+** Thread safety of the shared dictionary. All writers share one DataInfo
+** and one TableWritePlanCache.
+** - DataInfo is accessed by PdbMlWriter only when building a table write
+**   plan, under the dictionary lock, PdbMlWriter::GetDictionaryMutex(),
+**   which PdbMlSchema takes as well.
+** - Everything else the writers need from the dictionary, row validation
+**   included, is read from the cached plans, which are immutable once
+**   inserted and are never replaced, so after the first entries the
+**   writers run without touching DataInfo or taking the lock.
+** - CIF parsing uses global parser state, so parses take the parser lock,
+**   PdbMlSchema::GetParseMutex(). Writers never take it, so a parse
+**   overlaps with the writing of other entries.
+** - Output sinks, writers and parsed files are private to an entry.
+*/
+class BatchConverter
+{
+  public:
+    // Zero threads means one per online CPU. Zero in-flight entries
+    // means twice the number of threads.
+    BatchConverter(DataInfo& dataInfo, const std::string& ns,
+      const std::string& schemaPrefix = std::string(),
+      const unsigned int numThreads = 0, const unsigned int maxInFlight = 0);
+    ~BatchConverter();
+
+    unsigned int GetNumThreads() const;
+
+    TableWritePlanCache& GetPlanCache();
+
+    // Off by default. When on, the writer metrics of each entry are
+    // recorded in the entry.
+    void SetCollectMetrics(const bool collectMetrics);
+    bool GetCollectMetrics() const;
+
+    // Sink of the diagnostics of all entries, standard error by default.
+    // It is shared by the writer threads.
+    void SetDiagnosticSink(DiagnosticSink& diagnostics);
+    DiagnosticSink& GetDiagnosticSink();
+
+    // Converts all entries and fills in their results. Failures of single
+    // entries are reported in the entries and do not stop the batch.
+    void Convert(std::vector<BatchEntry>& entries);
+
+    // One tab separated line per entry: status, input size, output size,
+    // parse and write seconds, input file name and error.
+    static void WriteReport(std::ostream& io,
+      const std::vector<BatchEntry>& entries);
+
+    // Adds the metrics of all entries to the given metrics
+    static void MergeMetrics(WriterMetrics& metrics,
+      const std::vector<BatchEntry>& entries);
+
+  private:
+    friend class BatchEntryTask;
+
+    DataInfo& _dataInfo;
+    std::string _ns;
+    std::string _schemaPrefix;
+    unsigned int _maxInFlight;
+    bool _collectMetrics;
+    DiagnosticSink* _diagnostics;
+
+    TableWritePlanCache _planCache;
+    ThreadPool _pool;
+
+    unsigned int _numInFlight;
+    Mutex _mutex;
+    Condition _entryDone;
+
+    BatchConverter(const BatchConverter&);
+    BatchConverter& operator=(const BatchConverter&);
+
+    void _EntryDone();
+};
+
+
+#endif
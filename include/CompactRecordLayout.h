@@ -0,0 +1,80 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file CompactRecordLayout.h
+**
+** Column layouts of the compact record form of categories.
+*/
+
+
+#ifndef COMPACTRECORDLAYOUT_H
+#define COMPACTRECORDLAYOUT_H
+
+
+#include <string>
+#include <vector>
+
+
+typedef enum
+{
+    // Right justified in the column width, written as is
+    eCOMPACT_PADDED = 0,
+
+    // Preceded by a space, spaces escaped, not padded
+    eCOMPACT_ESCAPED
+} eCompactColumnStyle;
+
+
+/**
+** In the compact record form, a category is one element with an empty
+** element per row. The id of the row is an attribute, padded with its
+** quotes to the id width, and the other columns follow as character data,
+** each followed by a space. An empty cell is written as the unknown value
+** without the space, as the original atom_site form did. Columns that the
+** table does not have are left out.
+*/
+class CompactRecordLayout
+{
+  public:
+    class Column
+    {
+      public:
+        std::string name;
+        unsigned int width;
+        eCompactColumnStyle style;
+    };
+
+    CompactRecordLayout(const std::string& categoryTag,
+      const std::string& recordTag, const std::string& idColumn,
+      const unsigned int idWidth);
+    ~CompactRecordLayout();
+
+    void AddColumn(const std::string& name, const unsigned int width,
+      const eCompactColumnStyle style = eCOMPACT_PADDED);
+
+    const std::string& GetCategoryTag() const;
+    const std::string& GetRecordTag() const;
+    const std::string& GetIdColumn() const;
+    unsigned int GetIdWidth() const;
+
+    unsigned int GetNumColumns() const;
+    const Column& GetColumn(const unsigned int columnIndex) const;
+
+    // The "atom_record" form of atom_site
+    static const CompactRecordLayout& GetAtomSiteLayout();
+
+  private:
+    std::string _categoryTag;
+    std::string _recordTag;
+    std::string _idColumn;
+    unsigned int _idWidth;
+
+    std::vector<Column> _columns;
+};
+
+
+#endif
@@ -0,0 +1,104 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file CompressedSink.h
+**
+** Output sinks that compress the data on the fly.
+*/
+
+
+#ifndef COMPRESSEDSINK_H
+#define COMPRESSEDSINK_H
+
+
+#include <cstddef>
+#include <vector>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "XmlSink.h"
+
+
+/**
+** The compressed sinks pass the compressed data on to another sink, e.g.
+** a StreamSink over an ofstream. Flush() hands over what the compressor
+** has produced so far, but does not force the compressor to flush, since
+** that would cost compression ratio at every category boundary. The
+** stream is complete only after Finish(), which the destructor calls if
+** it has not been called before. The output sink must outlive the
+** compressed sink.
+*/
+
+#ifdef HAVE_ZLIB
+class GzipSink : public XmlSink
+{
+  public:
+    static const int DEFAULT_LEVEL;
+
+    // Level from 1 (fastest) to 9 (best compression)
+    GzipSink(XmlSink& out, const int level = DEFAULT_LEVEL);
+    ~GzipSink();
+
+    void Write(const char* data, const size_t len);
+    void Flush();
+
+    void Finish();
+
+    bool IsGood() const;
+
+  private:
+    XmlSink& _out;
+    z_stream _stream;
+    std::vector<char> _outBuf;
+    bool _finished;
+    bool _good;
+
+    GzipSink(const GzipSink&);
+    GzipSink& operator=(const GzipSink&);
+
+    void _Deflate(const char* data, const size_t len, const int flush);
+};
+#endif
+
+
+#ifdef HAVE_ZSTD
+class ZstdSink : public XmlSink
+{
+  public:
+    static const int DEFAULT_LEVEL;
+
+    // Level from 1 (fastest) to ZSTD_maxCLevel() (best compression)
+    ZstdSink(XmlSink& out, const int level = DEFAULT_LEVEL);
+    ~ZstdSink();
+
+    void Write(const char* data, const size_t len);
+    void Flush();
+
+    void Finish();
+
+    bool IsGood() const;
+
+  private:
+    XmlSink& _out;
+    ZSTD_CStream* _stream;
+    std::vector<char> _outBuf;
+    bool _finished;
+    bool _good;
+
+    ZstdSink(const ZstdSink&);
+    ZstdSink& operator=(const ZstdSink&);
+};
+#endif
+
+
+#endif
@@ -0,0 +1,215 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file DiagnosticSink.h
+**
+** Diagnostics reported by the XML writers and the sinks they go to.
+*/
+
+
+#ifndef DIAGNOSTICSINK_H
+#define DIAGNOSTICSINK_H
+
+
+#include <string>
+#include <vector>
+#include <map>
+#include <ostream>
+
+#include "Mutex.h"
+
+
+typedef enum
+{
+    // Item not defined in the dictionary, not converted
+    eDIAG_ITEM_NOT_DEFINED = 0,
+
+    // Table not converted, since none of its items is defined
+    eDIAG_TABLE_NO_ITEMS,
+
+    // Table not converted, since none of its items is a key
+    eDIAG_TABLE_NO_KEYS,
+
+    // Table not converted, since none of its rows is valid
+    eDIAG_TABLE_NO_ROWS,
+
+    // Row not converted, since it failed the dictionary validation
+    eDIAG_ROW_INVALID,
+
+    // Value of an item written as is, since it could not be formatted
+    eDIAG_VALUE_NOT_FORMATTED,
+
+    // Value of an integer or a float item that is not a valid number. The
+    // detail is the conversion error.
+    eDIAG_VALUE_NOT_INTEGER,
+    eDIAG_VALUE_NOT_FLOAT,
+
+    eDIAG_NUM_CODES
+} eDiagnosticCode;
+
+
+/**
+** One diagnostic with its context. The item is the attribute name, the
+** row is counted from one. Context that is not known is left empty, or
+** zero for the row.
+*/
+class Diagnostic
+{
+  public:
+    Diagnostic();
+    Diagnostic(const eDiagnosticCode diagCode, const std::string& diagCategory,
+      const std::string& diagItem = std::string(),
+      const unsigned int diagRow = 0,
+      const std::string& diagValue = std::string(),
+      const std::string& diagDetail = std::string());
+
+    eDiagnosticCode code;
+    std::string category;
+    std::string item;
+    unsigned int row;
+    std::string value;
+    std::string detail;
+
+    // The warning text, as printed by the writers before diagnostics
+    void GetMessage(std::string& message) const;
+
+    // Count of diagnostics of the code in the category, for summaries,
+    // e.g. "12,345 rows skipped in atom_site"
+    static void GetSummary(std::string& summary, const eDiagnosticCode code,
+      const std::string& category, const unsigned long count);
+};
+
+
+/**
+** Sinks may be shared by writers on different threads. Report() of all
+** the sinks here can be called concurrently.
+*/
+class DiagnosticSink
+{
+  public:
+    virtual ~DiagnosticSink();
+
+    virtual void Report(const Diagnostic& diag) = 0;
+};
+
+
+class NullDiagnosticSink : public DiagnosticSink
+{
+  public:
+    NullDiagnosticSink();
+    ~NullDiagnosticSink();
+
+    void Report(const Diagnostic& diag);
+};
+
+
+/**
+** Writes the message of each diagnostic, in one write, without flushing
+** the stream. Writers report to the standard error sink unless another
+** sink is set, which keeps the warnings they always printed.
+*/
+class StreamDiagnosticSink : public DiagnosticSink
+{
+  public:
+    StreamDiagnosticSink(std::ostream& io);
+    ~StreamDiagnosticSink();
+
+    void Report(const Diagnostic& diag);
+
+    static StreamDiagnosticSink& GetStandardError();
+
+  private:
+    std::ostream& _io;
+    Mutex _mutex;
+
+    StreamDiagnosticSink(const StreamDiagnosticSink&);
+    StreamDiagnosticSink& operator=(const StreamDiagnosticSink&);
+};
+
+
+/**
+** Counts the diagnostics of each code per category.
+*/
+class SummaryDiagnosticSink : public DiagnosticSink
+{
+  public:
+    SummaryDiagnosticSink();
+    ~SummaryDiagnosticSink();
+
+    void Report(const Diagnostic& diag);
+
+    unsigned long GetCount(const eDiagnosticCode code,
+      const std::string& category) const;
+    unsigned long GetTotalCount() const;
+
+    void Clear();
+
+    // One line per category and code, in category order
+    void WriteSummary(std::ostream& io) const;
+
+  private:
+    // Counts per category, indexed by code
+    std::map<std::string, std::vector<unsigned long> > _counts;
+    mutable Mutex _mutex;
+
+    SummaryDiagnosticSink(const SummaryDiagnosticSink&);
+    SummaryDiagnosticSink& operator=(const SummaryDiagnosticSink&);
+};
+
+
+/**
+** Passes at most the given number of diagnostics of each code per
+** category on to another sink, and counts the rest.
+*/
+class CappedDiagnosticSink : public DiagnosticSink
+{
+  public:
+    CappedDiagnosticSink(DiagnosticSink& sink,
+      const unsigned int maxPerCategory);
+    ~CappedDiagnosticSink();
+
+    void Report(const Diagnostic& diag);
+
+    const SummaryDiagnosticSink& GetSuppressed() const;
+
+    // Summary of the diagnostics that were not passed on
+    void WriteSuppressed(std::ostream& io) const;
+
+  private:
+    DiagnosticSink& _sink;
+    unsigned int _maxPerCategory;
+
+    SummaryDiagnosticSink _reported;
+    SummaryDiagnosticSink _suppressed;
+    Mutex _mutex;
+
+    CappedDiagnosticSink(const CappedDiagnosticSink&);
+    CappedDiagnosticSink& operator=(const CappedDiagnosticSink&);
+};
+
+
+/**
+** Keeps diagnostics in the order they are reported, to be passed on
+** later. Used by one thread at a time.
+*/
+class DiagnosticBuffer : public DiagnosticSink
+{
+  public:
+    DiagnosticBuffer();
+    ~DiagnosticBuffer();
+
+    void Report(const Diagnostic& diag);
+
+    void Replay(DiagnosticSink& sink) const;
+    void Clear();
+
+  private:
+    std::vector<Diagnostic> _diags;
+};
+
+
+#endif
@@ -0,0 +1,178 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file KeyRelationGraph.h
+**
+** Parent-child key relationships compiled for the schema key/keyref
+** generation.
+*/
+
+
+#ifndef KEYRELATIONGRAPH_H
+#define KEYRELATIONGRAPH_H
+
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include "DataInfo.h"
+#include "ParentChild.h"
+
+
+// Which parent-child relationships become XSD keys, uniques and keyrefs.
+typedef enum
+{
+    // Only relationships on complete category keys. Non-key items are
+    // skipped.
+    eREFERENCES_KEYS_ONLY = 0,
+
+    // Relationships on supersets of category keys. Non-key items are
+    // skipped, if not mandatory or if they can be inapplicable.
+    eREFERENCES_KEYS_WITH_MANDATORY_DET,
+
+    // Relationships on any items, which are skipped, if not mandatory or
+    // if they can be inapplicable.
+    eREFERENCES_NO_KEYS_WITH_MANDATORY_DET,
+
+    // Relationships on any items, which are skipped, if they can be
+    // inapplicable.
+    eREFERENCES_NO_KEYS_NO_MANDATORY_DET
+} eReferencePolicy;
+
+
+/**
+** Parent combo keys of categories with their child keys, reduced by the
+** reference policy. Item names are interned and the relationships are
+** stored in flat arrays that index each other by ranges. Built once per
+** dictionary and read-only afterwards, so that it can be shared by
+** concurrent readers.
+*/
+class KeyRelationGraph
+{
+  public:
+    static const unsigned int NO_ITEM;
+
+    // Combo key of a parent category, with the items that are not
+    // participating in the relationship removed.
+    class ParentKey
+    {
+      public:
+        // Relation items
+        unsigned int itemsBegin;
+        unsigned int itemsEnd;
+
+        // Child categories
+        unsigned int childrenBegin;
+        unsigned int childrenEnd;
+
+        // All of the parent category keys and nothing else
+        bool allKeyItems;
+
+        // All of the parent category keys, possibly with other items
+        bool keysSuperset;
+    };
+
+    class ChildCategory
+    {
+      public:
+        std::string catName;
+
+        // Child keys
+        unsigned int keysBegin;
+        unsigned int keysEnd;
+    };
+
+    class ChildKey
+    {
+      public:
+        // Relation items in the relationship order
+        unsigned int itemsBegin;
+        unsigned int itemsEnd;
+
+        // Relation items in the order of the parent items names, as
+        // written in keyref fields
+        unsigned int fieldsBegin;
+        unsigned int fieldsEnd;
+    };
+
+    KeyRelationGraph();
+    ~KeyRelationGraph();
+
+    void Build(ParentChild& parentChild, DataInfo& dataInfo,
+      const std::vector<std::string>& categories,
+      const std::vector<std::string>& items,
+      const eReferencePolicy policy);
+    void Clear();
+
+    eReferencePolicy GetPolicy() const;
+
+    // NO_ITEM if the item is not in the graph
+    unsigned int GetItemId(const std::string& itemName) const;
+
+    const std::string& GetItemName(const unsigned int itemId) const;
+    const std::string& GetAttribName(const unsigned int itemId) const;
+
+    bool IsKeyItem(const unsigned int itemId) const;
+    bool IsMandatoryItem(const unsigned int itemId) const;
+    bool IsSkipParentItem(const unsigned int itemId) const;
+    bool IsSkipChildItem(const unsigned int itemId) const;
+
+    // Policy checks for items that are not in the graph
+    static bool IsSkipParentItem(DataInfo& dataInfo,
+      const std::string& itemName, const eReferencePolicy policy);
+    static bool IsSkipChildItem(DataInfo& dataInfo,
+      const std::string& itemName, const eReferencePolicy policy);
+
+    // Range of parent keys of a category. Empty, if the category is not a
+    // parent.
+    void GetParentKeys(unsigned int& begin, unsigned int& end,
+      const std::string& catName) const;
+
+    const ParentKey& GetParentKey(const unsigned int keyIndex) const;
+    const ChildCategory& GetChildCategory(const unsigned int childIndex) const;
+    const ChildKey& GetChildKey(const unsigned int keyIndex) const;
+
+    // Item id of a relation item
+    unsigned int GetRelationItem(const unsigned int index) const;
+
+    void GetRelationItemsNames(std::vector<std::string>& itemsNames,
+      const unsigned int begin, const unsigned int end) const;
+
+  private:
+    eReferencePolicy _policy;
+
+    std::map<std::string, unsigned int> _itemIds;
+    std::vector<std::string> _itemNames;
+    std::vector<std::string> _attribNames;
+
+    // Item property bits, indexed by the item id
+    std::vector<unsigned char> _itemFlags;
+
+    std::map<std::string, std::pair<unsigned int, unsigned int> > _catKeys;
+    std::vector<ParentKey> _parentKeys;
+    std::vector<ChildCategory> _children;
+    std::vector<ChildKey> _childKeys;
+    std::vector<unsigned int> _relationItems;
+
+    KeyRelationGraph(const KeyRelationGraph&);
+    KeyRelationGraph& operator=(const KeyRelationGraph&);
+
+    unsigned int _InternItem(DataInfo& dataInfo, const std::string& itemName);
+    void _InternItems(std::vector<unsigned int>& itemIds, DataInfo& dataInfo,
+      const std::vector<std::string>& itemsNames);
+
+    void _AddCategory(ParentChild& parentChild, DataInfo& dataInfo,
+      const std::string& catName);
+    void _AddParentKey(ParentChild& parentChild, DataInfo& dataInfo,
+      const std::vector<std::string>& parComboKey);
+    void _AddChildKeyFields(const std::vector<unsigned int>& parentItems,
+      const std::vector<unsigned int>& childItems);
+};
+
+
+#endif
@@ -0,0 +1,74 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file Mutex.h
+**
+** Mutex, scoped lock and condition variable wrappers.
+*/
+
+
+#ifndef MUTEX_H
+#define MUTEX_H
+
+
+#include <pthread.h>
+
+
+class Mutex
+{
+  public:
+    Mutex();
+    ~Mutex();
+
+    void Lock();
+    void Unlock();
+
+  private:
+    friend class Condition;
+
+    pthread_mutex_t _mutex;
+
+    Mutex(const Mutex&);
+    Mutex& operator=(const Mutex&);
+};
+
+
+class MutexLock
+{
+  public:
+    MutexLock(Mutex& mutex);
+    ~MutexLock();
+
+  private:
+    Mutex& _mutex;
+
+    MutexLock(const MutexLock&);
+    MutexLock& operator=(const MutexLock&);
+};
+
+
+class Condition
+{
+  public:
+    Condition();
+    ~Condition();
+
+    // Mutex must be locked by the caller
+    void Wait(Mutex& mutex);
+
+    void Signal();
+    void Broadcast();
+
+  private:
+    pthread_cond_t _cond;
+
+    Condition(const Condition&);
+    Condition& operator=(const Condition&);
+};
+
+
+#endif
@@ -0,0 +1,52 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file NumberLexer.h
+**
+** Non-throwing lexer of numeric CIF values.
+*/
+
+
+#ifndef NUMBERLEXER_H
+#define NUMBERLEXER_H
+
+
+#include <cstddef>
+
+
+typedef enum
+{
+    eNUMBER_OTHER = 0,   // not in the strict grammar, e.g. blanks or "1e"
+    eNUMBER_INTEGER,     // [+-]?[0-9]{1,9}
+    eNUMBER_DECIMAL,     // [+-]?([0-9]+(\.[0-9]*)?|\.[0-9]+)
+    eNUMBER_SCIENTIFIC   // eNUMBER_DECIMAL followed by [eE][+-]?[0-9]+
+} eNumberSyntax;
+
+
+/**
+** Classifies a value in one pass, without allocating or throwing. The
+** grammar is deliberately strict: every value it accepts is also accepted
+** by the String conversion functions, so writers can take a fast path for
+** the accepted values and leave everything else to the generic code.
+** Integers with more than nine digits, which may not fit in an int, are
+** reported as eNUMBER_DECIMAL.
+*/
+class NumberLexer
+{
+  public:
+    // Values longer than this are always reported as eNUMBER_OTHER, so
+    // that range checks are left to the generic conversion.
+    static const size_t MAX_LENGTH = 32;
+
+    static eNumberSyntax Lex(const char* data, const size_t len);
+
+  private:
+    NumberLexer();
+};
+
+
+#endif
@@ -0,0 +1,63 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file ParallelTableWriter.h
+**
+** Writes the categories of a datablock on a thread pool.
+*/
+
+
+#ifndef PARALLELTABLEWRITER_H
+#define PARALLELTABLEWRITER_H
+
+
+#include <vector>
+
+#include "ISTable.h"
+#include "ThreadPool.h"
+#include "PdbMlWriter.h"
+
+
+/**
+** Each table is serialized into its own buffer by a worker thread. Tables
+** with more than the split number of rows are cut into row ranges that
+** are serialized independently. The buffers are then appended to the
+** writer in sorted table name order, so the output is byte identical to
+** calling PdbMlWriter::WriteTable() for each table in that order, and so
+** are the diagnostics reported to the writer's sink. Write plans are
+** built, and table columns are looked up, on the calling thread before
+** any worker starts, so workers only read cells by index. If the
+** writer has metrics set, the wall time of a table is the sum of the
+** times of its chunks and of its assembly.
+*/
+class ParallelTableWriter
+{
+  public:
+    static const unsigned int DEFAULT_SPLIT_ROWS;
+
+    // Zero threads means one per online CPU
+    ParallelTableWriter(PdbMlWriter& writer,
+      const unsigned int numThreads = 0);
+    ~ParallelTableWriter();
+
+    void SetSplitRows(const unsigned int splitRows);
+
+    // To be called between WriteDatablockOpeningTag() and
+    // WriteDatablockClosingTag() of the writer.
+    void WriteTables(const std::vector<ISTable*>& tables);
+
+  private:
+    PdbMlWriter& _writer;
+    ThreadPool _pool;
+    unsigned int _splitRows;
+
+    ParallelTableWriter(const ParallelTableWriter&);
+    ParallelTableWriter& operator=(const ParallelTableWriter&);
+};
+
+
+#endif
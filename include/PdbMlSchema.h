@@ -17,15 +17,15 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <map>
 
 #include "DataInfo.h"
 #include "ParentChild.h"
+#include "Mutex.h"
+#include "ThreadPool.h"
+#include "KeyRelationGraph.h"
 #include "XsdWriter.h"
 
-//#define VLAD_KEYS_ONLY_REFERENCES
-#define VLAD_KEYS_WITH_MANDATORY_DET_REFERENCES
-//#define VLAD_NO_KEYS_WITH_MANDATORY_DET_REFERENCES
-//#define VLAD_NO_KEYS_NO_MANDATORY_DET_REFERENCES
 
 class PdbMlSchema
 {
@@ -36,7 +36,23 @@ class PdbMlSchema
     PdbMlSchema(XsdWriter& xsdWriter, ParentChild& parentChild,
       DataInfo& dataInfo, const std::string& ns, const std::string& prefix);
 
-    void Convert();
+    // With more than one thread, zero meaning one per online CPU, the
+    // category types and keys are rendered in parallel and assembled in
+    // category order, giving the same schema as the serial conversion.
+    // Every dictionary read takes the dictionary lock of PdbMlWriter, so
+    // the dictionary objects need not be safe for concurrent readers.
+    void Convert(const unsigned int numThreads = 1);
+
+    // Which parent-child relationships are written as keys and keyrefs.
+    // The default is eREFERENCES_KEYS_WITH_MANDATORY_DET.
+    void SetReferencePolicy(const eReferencePolicy refPolicy);
+    eReferencePolicy GetReferencePolicy() const;
+
+    // Date written in the schema comment, as YYYY-MM-DD. Empty, the
+    // default, means the current date. A fixed date makes the schema
+    // reproducible.
+    void SetGenerationDate(const std::string& genDate);
+    const std::string& GetGenerationDate() const;
 
     static void MakeSchemaFileName(std::string& schemaFileName,
       const std::string& prefix,
@@ -49,24 +65,88 @@ class PdbMlSchema
     static void MakeCategoryTypeName(std::string& catTypeName,
       const std::string& catName);
 
+    // The CIF parser has global state. Every parse of the library, of the
+    // examples here and of BatchConverter, takes this lock.
+    static Mutex& GetParseMutex();
+
   private:
     static const std::string CATEGORY_ELEMENT_SUFFIX;
     static const std::string CATEGORY_TYPE_SUFFIX;
 
     static const std::string SCHEMA_LOCATION_DIRECTORY;
 
+    friend class SchemaFragmentTask;
+
+    // See GetParseMutex()
+    static Mutex _parseMutex;
+
     XsdWriter& _xsdWriter;
     ParentChild& _parentChild;
     DataInfo& _dataInfo;
     std::string _ns;
     std::string _nsPrefix;
     std::string _prefix;
+    eReferencePolicy _refPolicy;
+    std::string _genDate;
+
+    // Items of a category, as used in its complex type: the sorted keys
+    // and the non-key items, in the sorted order of all items.
+    class CategoryItems
+    {
+      public:
+        std::vector<std::string> keys;
+        std::vector<std::string> nonKeyItems;
+    };
+
+    // Indexed by the category name, built once per conversion. Writers
+    // of fragments use the index of the converting instance, and add
+    // the categories that are not in it to their own extra index.
+    std::map<std::string, CategoryItems> _catItems;
+    const std::map<std::string, CategoryItems>* _catIndex;
+    std::map<std::string, CategoryItems> _extraCatItems;
+
+    // Built with the index and shared with the writers of fragments
+    KeyRelationGraph _keyGraph;
+    const KeyRelationGraph* _keyRelations;
+
+    // Set during a parallel conversion
+    ThreadPool* _pool;
+
+    // Fragment writer sharing the dictionary and index of the parent
+    PdbMlSchema(XsdWriter& xsdWriter, const PdbMlSchema& parent);
+
+    PdbMlSchema(const PdbMlSchema&);
+    PdbMlSchema& operator=(const PdbMlSchema&);
+
+    // Called with the dictionary lock held
+    void _BuildCategoryItemsIndex(const std::vector<std::string>& categories,
+      const std::vector<std::string>& items);
+    const CategoryItems& _GetCategoryItems(const std::string& catName);
+
+    // Dictionary reads of the category types and keys, which may run on
+    // the pool threads. Each takes the dictionary lock and copies its
+    // result out, as the dictionary may change its caches on any read.
+    void _GetCatKeys(std::vector<std::string>& keys,
+      const std::string& catName);
+    void _GetCatAttribute(std::vector<std::string>& values,
+      const std::string& catName, const std::string& category,
+      const std::string& attribName);
+    void _GetItemAttribute(std::vector<std::string>& values,
+      const std::string& itemName, const std::string& category,
+      const std::string& attribName);
+    bool _IsCatDefined(const std::string& catName);
+    bool _IsItemDefined(const std::string& itemName);
+    bool _IsKeyItem(const std::string& catName,
+      const std::string& attribName);
+    bool _IsItemMandatory(const std::string& itemName);
+    bool _IsSimpleDataType(const std::string& itemName);
+    eTypeCode _GetDataType(const std::string& itemName);
 
     void _WriteSchemaAttributes(const std::string& ns);
     void _WriteSchemaComment(const std::string& dictVer);
 
-    void _WriteCategoriesTypes(const std::vector<std::string>& categories,
-      const std::vector<std::string>& items);
+    void _WriteCategoriesTypes(const std::vector<std::string>& categories);
+    void _WriteCategoryType(const std::string& catName);
     void _WriteDatablockType(const std::vector<std::string>& categories);
     void _WriteDatablockElement(const std::vector<std::string>& categories);
 
@@ -78,6 +158,9 @@ class PdbMlSchema
 
     void _WriteCategoryKeysAndKeyrefs(const std::string& catName);
 
+    void _WriteFragments(const std::vector<std::string>& categories,
+      const bool keys);
+
     bool _WriteComboKey(const std::string& catName,
       const std::vector<std::string>& keyItems, const std::string& append,
       const bool asXsdKey = true);
@@ -94,29 +177,12 @@ class PdbMlSchema
     void _WriteDataTypeAsElement(const std::string& itemName);
     void _WriteDataTypeAsAttribute(const std::string& itemName);
 
-    void _FilterKeys(std::vector<std::vector<std::string> >& parComboKeys,
-      std::vector<std::vector<std::vector<std::vector<std::string> > > >&
-      allChildrenKeys, const std::string& catName);
-
-    bool _AreAllKeyItems(const std::vector<std::string>& itemsNames);
-
-    bool _AreSupersetOfAllKeyItems(const std::vector<std::string>& itemsNames);
-
     void _FindNonKeyItemsIndices(std::set<unsigned int>& nonMandIndices,
       const std::vector<std::string>& itemsNames);
 
     void _FindNonMandItemsIndices(std::set<unsigned int>& nonMandIndices,
       const std::vector<std::string>& itemsNames);
 
-    void _FindToSkipParentItemsIndices(std::set<unsigned int>& indices,
-      const std::vector<std::string>& itemsNames);
-
-    void _FindToSkipChildItemsIndices(std::set<unsigned int>& indices,
-      const std::vector<std::string>& itemsNames);
-
-    void _RemoveNonMandItems(std::vector<std::string>& itemsNames,
-      std::set<unsigned int>& nonMandIndices);
-
     bool _IsSkipParentItem(const std::string& itemName);
 
     bool _IsSkipChildItem(const std::string& itemName);
@@ -16,10 +16,16 @@
 
 
 #include <string>
+#include <map>
 #include <ostream>
 
 #include "ISTable.h"
+#include "XmlSink.h"
 #include "XmlWriter.h"
+#include "Mutex.h"
+#include "TableWritePlan.h"
+#include "WriterMetrics.h"
+#include "CompactRecordLayout.h"
 #include "DataInfo.h"
 
 
@@ -27,17 +33,58 @@ class PdbMlWriter : public XmlWriter
 {
   public:
     PdbMlWriter(std::ostream& io, const std::string& ns, DataInfo& dataInfo);
+    PdbMlWriter(XmlSink& sink, const std::string& ns, DataInfo& dataInfo);
 
     ~PdbMlWriter();
 
+    // Plans are cached per writer, unless a cache is shared between
+    // writers that use the same dictionary.
+    void SetPlanCache(TableWritePlanCache& planCache);
+    TableWritePlanCache& GetPlanCache();
+
+    // Per category metrics are recorded into the given metrics, and the
+    // output is timed, until NULL, the default, is set. Set between
+    // categories only. Each WriteDeclaration() counts as a document, so
+    // the datablocks of one output are one document.
+    void SetMetrics(WriterMetrics* metrics);
+    WriterMetrics* GetMetrics();
+
     // PDBML related API
     void WriteTable(ISTable* tIn,
       vector<unsigned int>& widths,
       const bool reCalcWidth = false,
       const vector<eTypeCode>& typeCodes = vector<eTypeCode>());
 
+    // Streaming API. Rows are pushed one at a time, in the layout of the
+    // column names given to BeginCategory(), and written the same way as
+    // by WriteTable(). Only the current row is held in memory.
+    void BeginCategory(const std::string& catName,
+      const std::vector<std::string>& columnNames,
+      const std::vector<unsigned int>& widths =
+      std::vector<unsigned int>(),
+      const std::vector<eTypeCode>& typeCodes = std::vector<eTypeCode>(),
+      const Char::eCompareType colCaseSense = Char::eCASE_SENSITIVE);
+    void PushRow(const std::vector<std::string>& row);
+    void EndCategory();
+
+    // Tables of the category are written in the compact record form of
+    // the layout, by WriteTable() and ParallelTableWriter, until NULL is
+    // set. The layout must outlive the writer. Streamed categories are
+    // always written in the regular form.
+    void SetCompactLayout(const std::string& catName,
+      const CompactRecordLayout* layout);
+    const CompactRecordLayout* GetCompactLayout(
+      const std::string& catName) const;
+
+    // Rows are written as they are, without validation
+    void WriteCompactTable(ISTable* tIn, const CompactRecordLayout& layout);
+
+    // Compact record form of atom_site
     void _writeAlternateAtomSiteTable(ISTable *tIn);
 
+    // Writes the XML declaration and counts the document in the metrics
+    void WriteDeclaration();
+
     void WriteDatablockOpeningTag();
     void WriteDatablockClosingTag();
 
@@ -46,9 +93,100 @@ class PdbMlWriter : public XmlWriter
     void WriteCategoryOpeningTag(const std::string& catName);
     void WriteCategoryClosingTag(const std::string& catName);
 
+    // DataInfo is not guaranteed to be safe for concurrent readers. Every
+    // dictionary read of the writers and of PdbMlSchema takes this lock.
+    static Mutex& GetDictionaryMutex();
+
   private:
+    friend class ParallelTableWriter;
+    friend class TableChunkTask;
+
     static std::string DATABLOCK_TAG;
+    // See GetDictionaryMutex()
+    static Mutex _dictionaryMutex;
+
     DataInfo& _dataInfo;
+
+    TableWritePlanCache _ownPlanCache;
+    TableWritePlanCache* _planCache;
+
+    std::map<std::string, const CompactRecordLayout*> _compactLayouts;
+
+    // Writer counters. Times are measured only while metrics are set.
+    WriterMetrics* _metrics;
+    double _dictionarySeconds;
+    unsigned long _rowsWritten;
+    unsigned long _rowsRejected;
+    unsigned long _cellsFailed;
+
+    // Counters at the start of a category
+    class MetricsMark
+    {
+      public:
+        double start;
+        double dictionarySeconds;
+        double outputSeconds;
+        unsigned long bytes;
+        unsigned long rowsWritten;
+        unsigned long rowsRejected;
+        unsigned long cellsFailed;
+    };
+
+    // State of the category being streamed
+    bool _streamStarted;
+    const TableWritePlan* _streamPlan;
+    std::string _streamCatName;
+    unsigned int _streamNumColumns;
+    std::vector<unsigned int> _streamWidths;
+    std::vector<const std::string*> _streamCells;
+    unsigned int _streamRowIndex;
+    bool _streamWroteRows;
+    MetricsMark _streamMark;
+
+    void _MarkMetrics(MetricsMark& mark);
+
+    // Adds the counters since the mark to the category metrics. Output
+    // is not counted for rows that are not written to the final output.
+    void _RecordMetrics(const MetricsMark& mark, const std::string& catName,
+      const bool countOutput = true);
+
+    const TableWritePlan& _GetTablePlan(const std::string& tableName,
+      const std::vector<std::string>& allColumnNames,
+      const unsigned int caseSense,
+      const std::vector<eTypeCode>& typeCodes);
+    const TableWritePlan& _MakeTablePlan(const std::string& tableName,
+      const std::vector<std::string>& allColumnNames,
+      const unsigned int caseSense,
+      const std::vector<eTypeCode>& typeCodes);
+
+    bool _CheckTablePlan(const TableWritePlan& plan,
+      const std::string& tableName);
+    void _ReportEmptyTable(const std::string& tableName);
+
+    void _WriteCategoryOpeningTag(const TableWritePlan& plan);
+    void _WriteCategoryClosingTag(const TableWritePlan& plan);
+
+    // Columns of the table in the order of the plan's column names
+    void _GetTableColumns(
+      std::vector<const std::vector<std::string>*>& columns,
+      const TableWritePlan& plan, ISTable* tIn);
+
+    bool _WriteTableRows(const TableWritePlan& plan,
+      const std::string& tableName,
+      const std::vector<const std::vector<std::string>*>& columns,
+      const unsigned int fromRow, const unsigned int toRow,
+      std::vector<unsigned int>& widths, const bool reCalcWidth,
+      const bool openCategory);
+
+    // Validation against the plan only, no dictionary lookups
+    bool _IsRowValid(const TableWritePlan& plan, const std::string& tableName,
+      const std::vector<const std::string*>& cells,
+      const unsigned int rowIndex);
+
+    void _WriteRow(const TableWritePlan& plan, const std::string& tableName,
+      const std::vector<const std::string*>& cells,
+      const unsigned int rowIndex, std::vector<unsigned int>& widths,
+      const bool reCalcWidth);
 };
 
 
@@ -0,0 +1,95 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file SchemaCache.h
+**
+** On-disk cache of generated XSD schemas.
+*/
+
+
+#ifndef SCHEMACACHE_H
+#define SCHEMACACHE_H
+
+
+#include <string>
+#include <ostream>
+
+#include "DataInfo.h"
+#include "ParentChild.h"
+#include "KeyRelationGraph.h"
+#include "XmlWriter.h"
+
+
+/**
+** Schemas are stored in the cache directory under a fingerprint of the
+** dictionary content read by PdbMlSchema and of the conversion options.
+** A cached schema is memory mapped and written out. A missing one is
+** generated, written out and stored, through a unique temporary file
+** that is renamed into place, so that concurrent processes never read a
+** partial schema.
+**
+** The generation date is part of the fingerprint only if it is set. If
+** it is not, a cached schema keeps the date it was first generated on,
+** and all hits give the same schema. Setting a date makes hits and fresh
+** generations identical.
+*/
+class SchemaCache
+{
+  public:
+    static const unsigned int FORMAT_VERSION;
+
+    SchemaCache(const std::string& cacheDir);
+    ~SchemaCache();
+
+    // Conversion options, see PdbMlSchema and XmlWriter
+    void SetReferencePolicy(const eReferencePolicy refPolicy);
+    void SetGenerationDate(const std::string& genDate);
+    void SetFormatMode(const eFormatMode formatMode);
+    void SetIndentWidth(const unsigned int indentWidth);
+    void SetNumThreads(const unsigned int numThreads);
+
+    // Writes the schema for the dictionary. Returns true if it was served
+    // from the cache. Failures to store the schema are reported as
+    // warnings, failures to write it to out throw runtime_error.
+    bool Write(std::ostream& out, ParentChild& parentChild,
+      DataInfo& dataInfo, const std::string& ns, const std::string& prefix);
+
+    // 16 hexadecimal digits of the 64-bit FNV-1a hash
+    std::string MakeFingerprint(ParentChild& parentChild, DataInfo& dataInfo,
+      const std::string& ns, const std::string& prefix) const;
+
+    const std::string& GetCacheDir() const;
+    void MakeCacheFileName(std::string& cacheFileName,
+      const std::string& prefix, const std::string& fingerprint) const;
+
+    // Timing of the last Write(), in seconds
+    double GetFingerprintSeconds() const;
+    double GetWriteSeconds() const;
+
+  private:
+    std::string _cacheDir;
+
+    eReferencePolicy _refPolicy;
+    std::string _genDate;
+    eFormatMode _formatMode;
+    unsigned int _indentWidth;
+    unsigned int _numThreads;
+
+    double _fingerprintSeconds;
+    double _writeSeconds;
+
+    SchemaCache(const SchemaCache&);
+    SchemaCache& operator=(const SchemaCache&);
+
+    bool _WriteCached(std::ostream& out, const std::string& cacheFileName);
+    void _Generate(std::string& schema, ParentChild& parentChild,
+      DataInfo& dataInfo, const std::string& ns, const std::string& prefix);
+    bool _Store(const std::string& cacheFileName, const std::string& schema);
+};
+
+
+#endif
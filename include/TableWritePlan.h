@@ -0,0 +1,127 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file TableWritePlan.h
+**
+** Precompiled per-table write plan and plan cache.
+*/
+
+
+#ifndef TABLEWRITEPLAN_H
+#define TABLEWRITEPLAN_H
+
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include "rcsb_types.h"
+#include "Mutex.h"
+
+
+typedef enum
+{
+    ePLAN_STATUS_OK = 0,
+    ePLAN_STATUS_NO_ITEMS,
+    ePLAN_STATUS_NO_KEYS
+} ePlanStatus;
+
+
+/**
+** Everything PdbMlWriter::WriteTable() derives from the dictionary for a
+** table with a given set of columns: the used columns in output order,
+** their key/non-key split, types and nullability, plus the qualified
+** markup around each of them, rendered once.
+*/
+class TableWritePlan
+{
+  public:
+    TableWritePlan();
+    ~TableWritePlan();
+
+    ePlanStatus status;
+
+    // Columns of the table whose items the dictionary does not define
+    std::vector<std::string> skippedItems;
+
+    // Defined columns, sorted by name, and their indices in the table
+    std::vector<std::string> columnNames;
+    std::vector<unsigned int> columnIndices;
+
+    std::vector<bool> keyColumns;
+    std::vector<bool> allowedNullColumns;
+    std::vector<eTypeCode> types;
+
+    bool isAllKey;
+
+    // "<ns:tableCategory", "</ns:tableCategory"
+    std::string categoryOpeningTag;
+    std::string categoryClosingTag;
+
+    // "<ns:table", "</ns:table"
+    std::string rowOpeningTag;
+    std::string rowClosingTag;
+
+    // Key columns: " name=\"". Non-key columns: "<ns:name".
+    std::vector<std::string> openingTags;
+    // Non-key columns: "</ns:name"
+    std::vector<std::string> closingTags;
+
+    // Dictionary enumeration values of each column
+    std::vector<std::vector<std::string> > enums;
+
+    const std::string& StandardizeEnum(const unsigned int column,
+      const std::string& value) const;
+
+    // Same check as DataInfo::AreItemsValuesValid(): columns that do not
+    // allow nulls must not have empty cells. The cells are in the order
+    // of columnNames. Returns false, and the first failing column, if the
+    // row is not valid. Nothing global is touched, so rows can be
+    // validated concurrently.
+    bool IsRowValid(const std::vector<const std::string*>& cells,
+      unsigned int& failedColumn) const;
+};
+
+
+/**
+** Plans keyed by namespace, table name, column case sensitivity, column
+** names and explicit type codes. A cache can be shared by several writers,
+** also on different threads, as long as they all use the same dictionary.
+** Plans are never replaced or removed before Clear(), so references to
+** them stay valid; Clear() must not run concurrently with other calls.
+*/
+class TableWritePlanCache
+{
+  public:
+    TableWritePlanCache();
+    ~TableWritePlanCache();
+
+    static void MakeKey(std::string& key, const std::string& ns,
+      const std::string& tableName, const unsigned int caseSense,
+      const std::vector<std::string>& columnNames,
+      const std::vector<eTypeCode>& typeCodes);
+
+    TableWritePlan* Find(const std::string& key);
+
+    // Takes ownership of the plan. If a plan with the same key has been
+    // inserted meanwhile, that one is kept and returned.
+    TableWritePlan& Insert(const std::string& key, TableWritePlan* plan);
+
+    unsigned int GetNumPlans();
+
+    void Clear();
+
+  private:
+    std::map<std::string, TableWritePlan*> _plans;
+    Mutex _mutex;
+
+    TableWritePlanCache(const TableWritePlanCache&);
+    TableWritePlanCache& operator=(const TableWritePlanCache&);
+};
+
+
+#endif
@@ -0,0 +1,68 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file ThreadPool.h
+**
+** Fixed size pool of worker threads.
+*/
+
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+
+#include <vector>
+#include <deque>
+#include <pthread.h>
+
+#include "Mutex.h"
+
+
+class ThreadTask
+{
+  public:
+    virtual ~ThreadTask();
+
+    // Must not throw
+    virtual void Run() = 0;
+};
+
+
+class ThreadPool
+{
+  public:
+    // Zero threads means one per online CPU
+    ThreadPool(const unsigned int numThreads = 0);
+    ~ThreadPool();
+
+    static unsigned int GetNumCpus();
+
+    unsigned int GetNumThreads() const;
+
+    // Tasks are not owned by the pool and must outlive Wait().
+    void Submit(ThreadTask* task);
+    void Wait();
+
+  private:
+    std::vector<pthread_t> _threads;
+    std::deque<ThreadTask*> _tasks;
+    unsigned int _numPending;
+    bool _stop;
+
+    Mutex _mutex;
+    Condition _taskReady;
+    Condition _allDone;
+
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+
+    static void* _Run(void* arg);
+    void _Work();
+};
+
+
+#endif
@@ -0,0 +1,96 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file WriterMetrics.h
+**
+** Per category counters and timings of PDBML writers.
+*/
+
+
+#ifndef WRITERMETRICS_H
+#define WRITERMETRICS_H
+
+
+#include <string>
+#include <map>
+#include <ostream>
+
+
+class CategoryMetrics
+{
+  public:
+    CategoryMetrics();
+
+    void Merge(const CategoryMetrics& other);
+
+    // Tables, or streamed categories, of this category written
+    unsigned long numTables;
+
+    unsigned long rowsWritten;
+
+    // Rows that failed the dictionary validation
+    unsigned long rowsRejected;
+
+    // Cells that were written as is, since they could not be formatted
+    unsigned long cellsFailed;
+
+    // Bytes of the category, tags included
+    unsigned long bytes;
+
+    double wallSeconds;
+
+    // Write plan lookups and builds, waiting for the dictionary lock
+    // included
+    double dictionarySeconds;
+
+    // Rest of the wall time, less the output time
+    double formatSeconds;
+
+    // Handing the data of the category to the output sink. The output
+    // buffer is flushed at both ends of each category while metrics are
+    // recorded, so this is the time of the category's own data.
+    double outputSeconds;
+};
+
+
+/**
+** Metrics of one or more documents. A writer records into the metrics
+** only while they are set to it, and only the metrics of one writer
+** should be recorded into at a time. Metrics of different writers, e.g.
+** of entries of a batch, are combined with Merge().
+*/
+class WriterMetrics
+{
+  public:
+    WriterMetrics();
+    ~WriterMetrics();
+
+    void Clear();
+    void Merge(const WriterMetrics& other);
+
+    CategoryMetrics& GetCategory(const std::string& catName);
+    const std::map<std::string, CategoryMetrics>& GetCategories() const;
+
+    void GetTotals(CategoryMetrics& totals) const;
+
+    void AddDocument();
+    unsigned long GetNumDocuments() const;
+
+    // One JSON object with the number of documents, the metrics of each
+    // category and their totals
+    void WriteJson(std::ostream& io) const;
+
+    // Monotonic clock used by the writers, in seconds
+    static double GetSeconds();
+
+  private:
+    unsigned long _numDocuments;
+    std::map<std::string, CategoryMetrics> _categories;
+};
+
+
+#endif
@@ -0,0 +1,112 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file XmlBuffer.h
+**
+** Contiguous append buffer in front of an output sink.
+*/
+
+
+#ifndef XMLBUFFER_H
+#define XMLBUFFER_H
+
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+#include "XmlSink.h"
+
+
+/**
+** Data is accumulated in one contiguous buffer and handed to the sink
+** only when the buffer fills up or when Flush() is called. Writers call
+** Flush() at natural boundaries (end of category, end of datablock), so
+** the underlying stream sees a few large writes instead of a flush per
+** line.
+*/
+class XmlBuffer
+{
+  public:
+    static const size_t DEFAULT_CAPACITY;
+
+    XmlBuffer(XmlSink& sink, const size_t capacity = DEFAULT_CAPACITY);
+    ~XmlBuffer();
+
+    inline void Append(const char c);
+    inline void Append(const char* data, const size_t len);
+    inline void Append(const char* str);
+    inline void Append(const std::string& str);
+
+    void AppendSpaces(const unsigned int num);
+    void AppendPadded(const std::string& str, const unsigned int width);
+
+    void Flush();
+
+    bool IsGood() const;
+
+    XmlSink& GetSink();
+
+    // Bytes appended so far, handed to the sink or not
+    unsigned long GetNumBytes() const;
+
+    // Time spent in the sink, measured only while enabled
+    void SetTimeSink(const bool timeSink);
+    double GetSinkSeconds() const;
+
+  private:
+    XmlSink& _sink;
+    std::string _buf;
+    size_t _capacity;
+
+    unsigned long _numSunkBytes;
+    bool _timeSink;
+    double _sinkSeconds;
+
+    XmlBuffer(const XmlBuffer&);
+    XmlBuffer& operator=(const XmlBuffer&);
+
+    void _Spill();
+    void _AppendLarge(const char* data, const size_t len);
+    void _WriteSink(const char* data, const size_t len);
+};
+
+
+inline void XmlBuffer::Append(const char c)
+{
+    if (_buf.size() >= _capacity)
+        _Spill();
+
+    _buf += c;
+}
+
+
+inline void XmlBuffer::Append(const char* data, const size_t len)
+{
+    if (_buf.size() + len > _capacity)
+    {
+        _AppendLarge(data, len);
+        return;
+    }
+
+    _buf.append(data, len);
+}
+
+
+inline void XmlBuffer::Append(const char* str)
+{
+    Append(str, strlen(str));
+}
+
+
+inline void XmlBuffer::Append(const std::string& str)
+{
+    Append(str.data(), str.size());
+}
+
+
+#endif
@@ -0,0 +1,59 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file XmlEscape.h
+**
+** Table driven XML escaping of character data.
+*/
+
+
+#ifndef XMLESCAPE_H
+#define XMLESCAPE_H
+
+
+#include <cstddef>
+
+#include "XmlBuffer.h"
+
+
+typedef enum
+{
+    eESCAPE_STRING = 0,  // white space to space, markup to entities
+    eESCAPE_TEXT,        // as eESCAPE_STRING, but new lines are kept
+    eESCAPE_SPACE        // space to "&#32;", everything else as is
+} eEscapeMode;
+
+
+typedef enum
+{
+    eESCAPE_KERNEL_SCALAR = 0,
+    eESCAPE_KERNEL_SSE2,
+    eESCAPE_KERNEL_AVX2
+} eEscapeKernel;
+
+
+/**
+** Every byte is classified through a 256 entry table. Clean runs are
+** located with a vector scan (SSE2 or AVX2, chosen at run time from the
+** CPU capabilities, with a scalar fallback) and copied in bulk, so only
+** the bytes that need replacing are handled one at a time.
+*/
+class XmlEscape
+{
+  public:
+    static void Escape(XmlBuffer& out, const char* data, const size_t len,
+      const eEscapeMode mode);
+
+    static eEscapeKernel GetKernel();
+    static void SetKernel(const eEscapeKernel kernel);
+
+  private:
+    XmlEscape();
+};
+
+
+#endif
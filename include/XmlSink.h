@@ -0,0 +1,65 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file XmlSink.h
+**
+** Output sinks used by the XML writers.
+*/
+
+
+#ifndef XMLSINK_H
+#define XMLSINK_H
+
+
+#include <cstddef>
+#include <string>
+#include <ostream>
+
+
+class XmlSink
+{
+  public:
+    virtual ~XmlSink();
+
+    virtual void Write(const char* data, const size_t len) = 0;
+    virtual void Flush() = 0;
+
+    virtual bool IsGood() const;
+};
+
+
+class StreamSink : public XmlSink
+{
+  public:
+    StreamSink(std::ostream& io);
+    ~StreamSink();
+
+    void Write(const char* data, const size_t len);
+    void Flush();
+
+    bool IsGood() const;
+
+  private:
+    std::ostream& _io;
+};
+
+
+class StringSink : public XmlSink
+{
+  public:
+    StringSink(std::string& str);
+    ~StringSink();
+
+    void Write(const char* data, const size_t len);
+    void Flush();
+
+  private:
+    std::string& _str;
+};
+
+
+#endif
@@ -19,12 +19,31 @@
 #include <ostream>
 
 #include "rcsb_types.h"
+#include "XmlSink.h"
+#include "XmlBuffer.h"
+#include "DiagnosticSink.h"
 
 
+typedef enum
+{
+    eFORMAT_PRETTY = 0,  // nested elements indented, one element per line
+    eFORMAT_COMPACT      // no indentation and no new lines between elements
+} eFormatMode;
+
+
+/**
+** Output goes through an internal buffer. It is handed to the sink at the
+** end of each category and datablock, when Flush() is called and when the
+** writer is destroyed. Flush() before writing to the underlying stream
+** directly.
+*/
 class XmlWriter
 {
   public:
+    static const unsigned int DEFAULT_INDENT_WIDTH;
+
     XmlWriter(std::ostream& io, const std::string& ns);
+    XmlWriter(XmlSink& sink, const std::string& ns);
     ~XmlWriter();
 
     const std::string& GetNamespace();
@@ -71,37 +90,92 @@ class XmlWriter
     void IncrementIndent(const unsigned int indentLevels = 1);
     void DecrementIndent(const unsigned int indentLevels = 1);
     void SetIndentSpaces(const unsigned int indentSpaces);
+    unsigned int GetIndentSpaces() const;
+
+    // Format policy. Indentation is tracked in both modes, but written
+    // only in the pretty mode. The indent width applies to subsequent
+    // IncrementIndent() and DecrementIndent() calls.
+    void SetFormatMode(const eFormatMode formatMode);
+    eFormatMode GetFormatMode() const;
+    void SetIndentWidth(const unsigned int indentWidth);
+    unsigned int GetIndentWidth() const;
+
     void WriteSpace();
     void WriteNewLine();
 
+    // New line that is part of character data, written in all modes
+    void WriteLineBreak();
+
+    // Separates attributes: a new line in the pretty mode, to be followed
+    // by Indent(), a space in the compact mode
+    void WriteAttributeBreak();
+
+    // Appends already formatted markup, e.g. rendered by another writer
+    void WriteRaw(const std::string& data);
+
+    void Flush();
+
+    // Bytes written so far, including those not flushed yet
+    unsigned long GetBytesWritten() const;
+
+    // Time spent in the output sink, measured only while enabled
+    void SetTimeOutput(const bool timeOutput);
+    double GetOutputSeconds() const;
+
+    // Diagnostics go to the standard error sink, unless another sink is
+    // set. The sink must outlive the writer.
+    void SetDiagnosticSink(DiagnosticSink& diagnostics);
+    DiagnosticSink& GetDiagnosticSink();
 
-    void _FormatData(const std::string& value, const unsigned int type,
+
+    // The numeric formatters return false, after writing the value as is
+    // and reporting a diagnostic, for values that are not valid numbers.
+    bool _FormatData(const std::string& value, const unsigned int type,
       const unsigned int width);
 
-    void _FormatFloatDataXML(const std::string& cs);
-    void _FormatIntegerDataXML(const std::string& cs);
+    bool _FormatFloatDataXML(const std::string& cs);
+    bool _FormatIntegerDataXML(const std::string& cs);
     void _FormatStringDataXML(const std::string& cs, const unsigned int width);
     void _FormatTextDataXML(const std::string& cs);
     void _FormatDateDataXML(const std::string& cs, const unsigned int width);
 
   protected:
-    std::ostream& _io;
+    XmlSink* _streamSink;
+    XmlBuffer _out;
     std::string _ns;
 
+    DiagnosticSink* _diagnostics;
+
+    // Context of the value being formatted, reported with formatting
+    // diagnostics. Set by derived writers, NULL or zero if not known.
+    const std::string* _diagCategory;
+    const std::string* _diagItem;
+    unsigned int _diagRow;
+
+    void _ReportValue(const eDiagnosticCode code, const std::string& value,
+      const std::string& detail = std::string());
+
+    void _QualifyNameXML(XmlBuffer& out, const std::string& name,
+      const std::string& ns = std::string(),
+      const bool doNotPrepUndscoreToNumb = false,
+      const bool doNotQualifyUnderscore = false);
+    void _QualifyNameXML(std::string& out, const std::string& name,
+      const std::string& ns = std::string(),
+      const bool doNotPrepUndscoreToNumb = false,
+      const bool doNotQualifyUnderscore = false);
+
   private:
     unsigned int _indentSpaces;
+    eFormatMode _formatMode;
+    unsigned int _indentWidth;
 
     void _WriteDeclarationOpeningTag();
     void _WriteDeclarationClosingTag();
 
-    void _WriteNamespaceXML(std::ostream& io, const std::string& ns);
+    void _WriteNamespaceXML(XmlBuffer& out, const std::string& ns);
 
     void _ConvertDataTypeXML(const eTypeCode iType);
 
-    void _QualifyNameXML(std::ostream& io, const std::string& name,
-      const std::string& ns = std::string(),
-      const bool doNotPrepUndscoreToNumb = false,
-      const bool doNotQualifyUnderscore = false);
 };
 
 
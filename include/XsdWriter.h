@@ -19,6 +19,7 @@
 #include <string>
 
 #include "rcsb_types.h"
+#include "XmlSink.h"
 #include "XmlWriter.h"
 
 
@@ -26,6 +27,7 @@ class XsdWriter : public XmlWriter
 {
   public:
     XsdWriter(std::ostream& io);
+    XsdWriter(XmlSink& sink);
  
     ~XsdWriter();
 
@@ -0,0 +1,91 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file CheckHarness.h
+**
+** Counting and reporting of the checks run by "make check".
+*/
+
+
+#ifndef CHECKHARNESS_H
+#define CHECKHARNESS_H
+
+
+#include <string>
+#include <ostream>
+
+#include "Mutex.h"
+#include "DiagnosticSink.h"
+
+
+/**
+** Failures are written as they happen, each group of checks ends with its
+** numbers of checks and failures.
+*/
+class CheckHarness
+{
+  public:
+    CheckHarness(std::ostream& io);
+    ~CheckHarness();
+
+    void Begin(const std::string& groupName);
+    void End();
+
+    // Returns the condition
+    bool Check(const bool condition, const std::string& what);
+
+    // Byte for byte. On a difference, the offset of the first differing
+    // byte and the text around it are written.
+    bool CheckEqual(const std::string& expected, const std::string& actual,
+      const std::string& what);
+
+    unsigned int GetNumChecks() const;
+    unsigned int GetNumFailures() const;
+
+  private:
+    std::ostream& _io;
+
+    std::string _groupName;
+    unsigned int _groupChecks;
+    unsigned int _groupFailures;
+
+    unsigned int _numChecks;
+    unsigned int _numFailures;
+
+    CheckHarness(const CheckHarness&);
+    CheckHarness& operator=(const CheckHarness&);
+
+    void _Fail(const std::string& what);
+};
+
+
+/**
+** Keeps every field of each diagnostic, one line per diagnostic, in the
+** order they are reported, so that runs can be compared as strings.
+*/
+class RecordingDiagnosticSink : public DiagnosticSink
+{
+  public:
+    RecordingDiagnosticSink();
+    ~RecordingDiagnosticSink();
+
+    void Report(const Diagnostic& diag);
+
+    const std::string& GetRecord() const;
+
+    void Clear();
+
+  private:
+    std::string _record;
+    Mutex _mutex;
+
+    RecordingDiagnosticSink(const RecordingDiagnosticSink&);
+    RecordingDiagnosticSink& operator=(const RecordingDiagnosticSink&);
+};
+
+
+#endif
@@ -0,0 +1,52 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file CheckSuites.h
+**
+** Check suites of the PDBML library, run by pdbml-check.
+*/
+
+
+#ifndef CHECKSUITES_H
+#define CHECKSUITES_H
+
+
+#include <string>
+#include <vector>
+
+#include "SyntheticData.h"
+#include "CheckHarness.h"
+
+
+// Categories that the dictionary of the checks defines
+void GetCheckSpecs(std::vector<SyntheticTableSpec>& specs);
+
+// The spec of the category, from GetCheckSpecs()
+SyntheticTableSpec GetCheckSpec(const std::string& catName);
+
+// XmlWriter float formatting against the String conversion functions
+void CheckFloatFormat(CheckHarness& harness);
+
+// Serial PdbMlWriter::WriteTable() against ParallelTableWriter
+void CheckParallelWriter(CheckHarness& harness,
+  SyntheticDictionary& dictionary);
+
+// PdbMlSchema::Convert() on one thread against several, for each reference
+// policy
+void CheckSchema(CheckHarness& harness, SyntheticDictionary& dictionary);
+
+// Output of the asynchronous and of the compressed sinks that are built,
+// decompressed, against that of a StringSink
+void CheckCompressedSinks(CheckHarness& harness,
+  SyntheticDictionary& dictionary);
+
+// Peak memory of streaming many rows against that of a few
+void CheckStreamingMemory(CheckHarness& harness,
+  SyntheticDictionary& dictionary);
+
+
+#endif